@@ -3,6 +3,6 @@
 mkdir build
 pushd build
 
-cl ..\frontend\console\main.c /O2 /Fetex2sdf.exe
+cl ..\frontend\console\main.c /O2 /openmp /Fetex2sdf.exe
 
 popd
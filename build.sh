@@ -1,4 +1,4 @@
 #!/bin/sh
 
 mkdir -p build
-gcc -O2 -Wall -pedantic frontend/console/main.c -o build/tex2sdf -lm
+gcc -O2 -Wall -pedantic -fopenmp frontend/console/main.c -o build/tex2sdf -lm
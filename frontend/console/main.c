@@ -18,6 +18,17 @@ static void show_help(void)
 {
 	fprintf(stderr, "tex2sdf <input> <output.tga> [flags]\n\n");
 	fprintf(stderr, "\t--sdf_range [number]\n");
+	fprintf(stderr, "\t--algorithm [eikonal_sweep|fast_marching|distance_transform|jump_flooding|dead_reckoning|antialiased_edt|multiresolution|auto|chamfer_3_4|chamfer_5_7_11]\n");
+	fprintf(stderr, "\t--sweep_order [column_major|row_major|wavefront]\n");
+	fprintf(stderr, "\t--narrow_band\n");
+	fprintf(stderr, "\t--max_iterations [number]\n");
+	fprintf(stderr, "\t--tolerance [number]\n");
+	fprintf(stderr, "\t--thread_count [number]\n");
+	fprintf(stderr, "\t--parallel_channels\n");
+	fprintf(stderr, "\t--interleaved_channels\n");
+	fprintf(stderr, "\t--compact_scratch\n");
+	fprintf(stderr, "\t--fixed_point_distances\n");
+	fprintf(stderr, "\t--in_place\n");
 }
 
 struct Argument_Parser {
@@ -89,6 +100,20 @@ static bool string_matches(const char *a, const char *b)
 	return 0 == strcmp(a, b);
 }
 
+static int pop_enum_value(const char *name, const char **names, int count)
+{
+	for(int i = 0; i < count; ++i) {
+		if(string_matches(name, names[i])) {
+			return i;
+		}
+	}
+
+	printf("Invalid value: %s\n\n", name);
+	show_help();
+	exit(1);
+	return 0;
+}
+
 int main(int argc, char **argv)
 {
 	// 1. Parse arguments
@@ -114,6 +139,43 @@ int main(int argc, char **argv)
 		if(string_matches(flag, "--sdf_range")) {
 			options.sdf_range = atof(pop_one_argument(&parser));
 		}
+		else if(string_matches(flag, "--algorithm")) {
+			const char *name = pop_one_argument(&parser);
+			const char *names[TEX2SDF_ALGORITHM_COUNT] = { "eikonal_sweep", "fast_marching", "distance_transform", "jump_flooding", "dead_reckoning", "antialiased_edt", "multiresolution", "auto", "chamfer_3_4", "chamfer_5_7_11" };
+			options.algorithm = pop_enum_value(name, names, TEX2SDF_ALGORITHM_COUNT);
+		}
+		else if(string_matches(flag, "--sweep_order")) {
+			const char *name = pop_one_argument(&parser);
+			const char *names[TEX2SDF_SWEEP_COUNT] = { "column_major", "row_major", "wavefront" };
+			options.sweep_order = pop_enum_value(name, names, TEX2SDF_SWEEP_COUNT);
+		}
+		else if(string_matches(flag, "--narrow_band")) {
+			options.narrow_band = 1;
+		}
+		else if(string_matches(flag, "--max_iterations")) {
+			options.max_iterations = atoi(pop_one_argument(&parser));
+		}
+		else if(string_matches(flag, "--tolerance")) {
+			options.tolerance = atof(pop_one_argument(&parser));
+		}
+		else if(string_matches(flag, "--thread_count")) {
+			options.thread_count = atoi(pop_one_argument(&parser));
+		}
+		else if(string_matches(flag, "--parallel_channels")) {
+			options.parallel_channels = 1;
+		}
+		else if(string_matches(flag, "--interleaved_channels")) {
+			options.interleaved_channels = 1;
+		}
+		else if(string_matches(flag, "--compact_scratch")) {
+			options.compact_scratch = 1;
+		}
+		else if(string_matches(flag, "--fixed_point_distances")) {
+			options.fixed_point_distances = 1;
+		}
+		else if(string_matches(flag, "--in_place")) {
+			options.in_place = 1;
+		}
 		else {
 			printf("Unknown flag %s\n", flag);
 			show_help();
@@ -8,3 +8,39 @@ echo
 echo "[0] ==== Testing C++ Compatibility ===="
 g++ -Wall -pedantic -std=c++11 testing/test_cpp_compat.cpp -o build/testing/test_cpp_compat || echo "-> Failed to compile as C++"
 build/testing/test_cpp_compat || echo "-> Failed to run C++ executable"
+
+echo
+echo "[1] ==== Testing shapes touching the border ===="
+gcc -Wall -pedantic -std=c99 testing/test_border.c -o build/testing/test_border -lm || echo "-> Failed to compile the border test"
+build/testing/test_border || echo "-> Distances next to the border are wrong"
+
+echo
+echo "[2] ==== Testing the distance transform against brute force ===="
+gcc -Wall -pedantic -std=c99 -O2 testing/test_distance_transform.c -o build/testing/test_distance_transform -lm || echo "-> Failed to compile the distance transform test"
+build/testing/test_distance_transform || echo "-> The distance transform is not exact"
+
+echo
+echo "[3] ==== Testing conversions through a context ===="
+gcc -Wall -pedantic -std=c99 -O2 testing/test_context.c -o build/testing/test_context -lm || echo "-> Failed to compile the context test"
+build/testing/test_context || echo "-> Converting through a context gives a different SDF"
+
+echo
+echo "[4] ==== Testing options that should not change the SDF ===="
+gcc -Wall -pedantic -std=c99 -O2 -fopenmp testing/test_options.c -o build/testing/test_options -lm || echo "-> Failed to compile the options test"
+gcc -Wall -pedantic -std=c99 -O2 -fopenmp -DTEX2SDF_NO_SIMD testing/test_options.c -o build/testing/test_options_no_simd -lm || echo "-> Failed to compile the options test without SIMD"
+gcc -Wall -pedantic -std=c99 -O2 -fopenmp -DTEX2SDF_NO_DISPATCH testing/test_options.c -o build/testing/test_options_no_dispatch -lm || echo "-> Failed to compile the options test without runtime dispatch"
+options_checksum=$(build/testing/test_options) || echo "-> Options change the SDF when they should not"
+options_checksum_no_simd=$(build/testing/test_options_no_simd) || echo "-> Options change the SDF when they should not (without SIMD)"
+options_checksum_no_dispatch=$(build/testing/test_options_no_dispatch) || echo "-> Options change the SDF when they should not (without runtime dispatch)"
+[ "$options_checksum" = "$options_checksum_no_simd" ] || echo "-> The SIMD and plain C kernels give different SDFs"
+[ "$options_checksum" = "$options_checksum_no_dispatch" ] || echo "-> The dispatched and direct kernels give different SDFs"
+
+echo
+echo "[5] ==== Testing a context with its own allocator ===="
+gcc -Wall -pedantic -std=c99 -O2 testing/test_allocator.c -o build/testing/test_allocator -lm || echo "-> Failed to compile the allocator test"
+build/testing/test_allocator || echo "-> The context does not use its allocator properly"
+
+echo
+echo "[6] ==== Testing conversions in place ===="
+gcc -Wall -pedantic -std=c99 -O2 testing/test_in_place.c -o build/testing/test_in_place -lm || echo "-> Failed to compile the in place test"
+build/testing/test_in_place || echo "-> Converting in place gives a different SDF"
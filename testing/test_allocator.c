@@ -0,0 +1,66 @@
+/*
+ * Checks a T2S_Context with its own allocator, which hands out memory that is deliberately not aligned:
+ * the SDFs have to match t2s_convert, and every block has to be freed once, with the size it was allocated with.
+ */
+#define TEX2SDF_IMPLEMENTATION
+#include "../tex2sdf.h"
+#include "test_common.h"
+
+static int live_allocation_count = 0;
+
+static void *misaligned_allocate(size_t size, size_t alignment, void *user)
+{
+	(void)alignment;
+	(void)user;
+	unsigned char *block = (unsigned char *)malloc(size + sizeof(size_t) + 3);
+	if(!block) {
+		return NULL;
+	}
+
+	memcpy(block, &size, sizeof(size_t));
+	live_allocation_count += 1;
+	return block + sizeof(size_t) + 3;
+}
+
+static void misaligned_deallocate(void *memory, size_t size, void *user)
+{
+	(void)user;
+	unsigned char *block = (unsigned char *)memory - sizeof(size_t) - 3;
+	size_t allocated_size;
+	memcpy(&allocated_size, block, sizeof(size_t));
+	if(allocated_size != size) {
+		fprintf(stderr, "allocator: freed %lu bytes of a %lu byte block\n", (unsigned long)size, (unsigned long)allocated_size);
+		live_allocation_count += 1000000; // (Fails the check at the end)
+	}
+
+	live_allocation_count -= 1;
+	free(block);
+}
+
+int main(void)
+{
+	struct T2S_Context context;
+	memset(&context, 0, sizeof(context));
+	context.allocator.allocate = misaligned_allocate;
+	context.allocator.deallocate = misaligned_deallocate;
+
+	// 1. Many conversions of different sizes, so the context grows its memory a few times
+	int passed = 1;
+	for(int test = 0; test < 150; ++test) {
+		const struct T2S_Image input = random_image(MAX_SIZE, 4);
+		const struct T2S_Options options = random_options();
+
+		struct T2S_Image expected = t2s_convert(input, options);
+		passed &= is_same("allocator", test, expected, t2s_convert_with_context(&context, input, options));
+		t2s_free_image(&expected);
+	}
+
+	// 2. Everything is given back when the context is freed
+	t2s_free_context(&context);
+	if(live_allocation_count != 0) {
+		fprintf(stderr, "allocator: %d allocations were not freed\n", live_allocation_count);
+		passed = 0;
+	}
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,77 @@
+/*
+ * Checks shapes that touch the border of the image.
+ * Outside the bounds of the image counts as outer, so going inwards from the border the SDF has to keep going further inside,
+ * the same as it does from any other outline. (This catches algorithms that only measure to outlines inside the image)
+ */
+#include <stdio.h>
+
+#define TEX2SDF_IMPLEMENTATION
+#include "../tex2sdf.h"
+
+#define SIZE 64
+#define STEPS 8
+
+static int check(const char *name, int algorithm, int sweep_order)
+{
+	// 1. A shape covering the whole image, apart from a hole in the middle, so it touches every border
+	static unsigned char mask[SIZE * SIZE];
+	for(int y = 0; y < SIZE; ++y) {
+		for(int x = 0; x < SIZE; ++x) {
+			const int is_hole = x >= 24 && x < 40 && y >= 24 && y < 40;
+			mask[y * SIZE + x] = is_hole ? 0 : 255;
+		}
+	}
+
+	struct T2S_Options options = t2s_get_default_options();
+	options.sdf_range = 16.0f;
+	options.algorithm = algorithm;
+	options.sweep_order = sweep_order;
+
+	struct T2S_Image input = { mask, SIZE, SIZE, 1 };
+	struct T2S_Image sdf = t2s_convert(input, options);
+	if(sdf.error) {
+		fprintf(stderr, "%s: %s\n", name, t2s_get_error_string(sdf.error));
+		return 0;
+	}
+
+	// 2. Walk in from the middle of each border. Every step is a pixel further inside, which lowers the output by about 8.
+	const int starts[4][4] = { { SIZE / 2, 0, 0, 1 }, { SIZE / 2, SIZE - 1, 0, -1 }, { 0, SIZE / 2, 1, 0 }, { SIZE - 1, SIZE / 2, -1, 0 } };
+	int passed = 1;
+	for(int side = 0; side < 4; ++side) {
+		int values[STEPS + 1];
+		for(int n = 0; n <= STEPS; ++n) {
+			values[n] = sdf.data[(starts[side][1] + n * starts[side][3]) * SIZE + starts[side][0] + n * starts[side][2]];
+		}
+
+		for(int n = 0; n < STEPS; ++n) {
+			if(values[n + 1] >= values[n] || values[n] - values[n + 1] > 10) {
+				fprintf(stderr, "%s (sweep order %d): border %d goes", name, sweep_order, side);
+				for(int m = 0; m <= STEPS; ++m) {
+					fprintf(stderr, " %d", values[m]);
+				}
+				fprintf(stderr, "\n");
+				passed = 0;
+				break;
+			}
+		}
+	}
+
+	t2s_free_image(&sdf);
+	return passed;
+}
+
+int main(void)
+{
+	int passed = 1;
+	for(int sweep_order = TEX2SDF_SWEEP_COLUMN_MAJOR; sweep_order <= TEX2SDF_SWEEP_ROW_MAJOR; ++sweep_order) {
+		passed &= check("eikonal_sweep", TEX2SDF_ALGORITHM_EIKONAL_SWEEP, sweep_order);
+		passed &= check("fast_marching", TEX2SDF_ALGORITHM_FAST_MARCHING, sweep_order);
+		passed &= check("distance_transform", TEX2SDF_ALGORITHM_DISTANCE_TRANSFORM, sweep_order);
+		passed &= check("jump_flooding", TEX2SDF_ALGORITHM_JUMP_FLOODING, sweep_order);
+		passed &= check("dead_reckoning", TEX2SDF_ALGORITHM_DEAD_RECKONING, sweep_order);
+		passed &= check("antialiased_edt", TEX2SDF_ALGORITHM_ANTIALIASED_EDT, sweep_order);
+		passed &= check("auto", TEX2SDF_ALGORITHM_AUTO, sweep_order);
+	}
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+/*
+ * Helpers for the tests that check conversions which should give the same SDF against each other:
+ * random masks and options, and comparing the SDFs.
+ * Include after tex2sdf.h (with TEX2SDF_IMPLEMENTATION defined).
+ */
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+#include <stdio.h>
+#include <string.h>
+
+#define MAX_SIZE 200
+#define MAX_BYTES (MAX_SIZE * MAX_SIZE * 4)
+
+static unsigned int random_state = 1;
+static unsigned char mask[MAX_BYTES];
+
+static int random_below(int limit)
+{
+	random_state = random_state * 1103515245u + 12345u;
+	return (int)((random_state >> 8) % (unsigned int)limit);
+}
+
+static struct T2S_Image random_image(int max_size, int max_channels)
+{
+	// A disc of a different size in each channel, with a grey (anti-aliased) rim
+	struct T2S_Image image;
+	memset(&image, 0, sizeof(image));
+	image.data = mask;
+	image.width = 1 + random_below(max_size);
+	image.height = 1 + random_below(max_size);
+	image.channels = 1 + random_below(max_channels);
+
+	const int center_x = random_below(image.width);
+	const int center_y = random_below(image.height);
+	const int radius = 1 + random_below(max_size / 3);
+	for(int y = 0; y < image.height; ++y) {
+		for(int x = 0; x < image.width; ++x) {
+			for(int channel = 0; channel < image.channels; ++channel) {
+				const int outside = (x - center_x) * (x - center_x) + (y - center_y) * (y - center_y) - radius * radius * (1 + channel);
+				image.data[t2s_at(&image, x, y, channel)] = outside < 0 ? 255 : (outside < 40 ? 128 : 0);
+			}
+		}
+	}
+
+	return image;
+}
+
+static struct T2S_Options random_options(void)
+{
+	struct T2S_Options options = t2s_get_default_options();
+	options.sdf_range = (float)(1 + random_below(16));
+	options.algorithm = random_below(TEX2SDF_ALGORITHM_COUNT);
+	options.sweep_order = random_below(TEX2SDF_SWEEP_COUNT);
+	options.narrow_band = random_below(2);
+	options.max_iterations = 1 + random_below(3);
+	options.parallel_channels = random_below(2);
+	options.interleaved_channels = random_below(2);
+	options.compact_scratch = random_below(2);
+	options.fixed_point_distances = random_below(2);
+	return options;
+}
+
+static int is_same(const char *name, int test, struct T2S_Image expected, struct T2S_Image actual)
+{
+	if(expected.error || actual.error) {
+		fprintf(stderr, "%s %d: %s / %s\n", name, test, t2s_get_error_string(expected.error), t2s_get_error_string(actual.error));
+		return 0;
+	}
+
+	const size_t size = (size_t)expected.width * (size_t)expected.height * (size_t)expected.channels;
+	if(actual.width != expected.width || actual.height != expected.height || actual.channels != expected.channels || (size && memcmp(expected.data, actual.data, size))) {
+		fprintf(stderr, "%s %d: %dx%dx%d gives a different SDF\n", name, test, expected.width, expected.height, expected.channels);
+		return 0;
+	}
+
+	return 1;
+}
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ * Checks that converting through a T2S_Context, which keeps its memory between conversions, gives the same SDFs as t2s_convert.
+ * Also reuses the same memory with t2s_convert_noalloc.
+ */
+#define TEX2SDF_IMPLEMENTATION
+#include "../tex2sdf.h"
+#include "test_common.h"
+
+int main(void)
+{
+	// 1. Many conversions of different sizes through the same context
+	struct T2S_Context context;
+	memset(&context, 0, sizeof(context));
+
+	int passed = 1;
+	for(int test = 0; test < 300; ++test) {
+		const struct T2S_Image input = random_image(MAX_SIZE, 4);
+		const struct T2S_Options options = random_options();
+
+		struct T2S_Image expected = t2s_convert(input, options);
+		const struct T2S_Image actual = t2s_convert_with_context(&context, input, options);
+		passed &= is_same("context", test, expected, actual);
+		if(actual.data_is_owned) {
+			fprintf(stderr, "context %d: the SDF should belong to the context\n", test);
+			passed = 0;
+		}
+		t2s_free_image(&expected);
+	}
+
+	// 2. Empty images (like the glyph of a space), on a context with no memory yet and on one that has some
+	for(int test = 0; test < 6; ++test) {
+		const int sizes[3][2] = { { 0, 0 }, { 0, 5 }, { 5, 0 } };
+		struct T2S_Context empty_context;
+		memset(&empty_context, 0, sizeof(empty_context));
+
+		struct T2S_Image input = random_image(MAX_SIZE, 4);
+		input.width = sizes[test % 3][0];
+		input.height = sizes[test % 3][1];
+		struct T2S_Options options = random_options();
+		options.algorithm = test;
+
+		struct T2S_Image expected = t2s_convert(input, options);
+		passed &= is_same("empty", test, expected, t2s_convert_with_context(&empty_context, input, options));
+		passed &= is_same("empty (reused)", test, expected, t2s_convert_with_context(&context, input, options));
+		t2s_free_image(&expected);
+		t2s_free_context(&empty_context);
+	}
+
+	t2s_free_context(&context);
+
+	// 3. The same memory reused with t2s_convert_noalloc, bigger than any of the images need
+	struct T2S_Allocation allocation;
+	memset(&allocation, 0, sizeof(allocation));
+	allocation.temporary_memory.capacity = 1 << 24;
+	allocation.temporary_memory.memory = malloc(allocation.temporary_memory.capacity);
+	allocation.return_data_memory.capacity = MAX_BYTES;
+	allocation.return_data_memory.memory = malloc(allocation.return_data_memory.capacity);
+
+	for(int test = 0; test < 100; ++test) {
+		const struct T2S_Image input = random_image(MAX_SIZE, 4);
+		struct T2S_Options options = random_options();
+		options.parallel_channels = 0; // (Would need temporary memory for each channel)
+
+		struct T2S_Image expected = t2s_convert(input, options);
+		passed &= is_same("noalloc", test, expected, t2s_convert_noalloc(input, options, &allocation));
+		t2s_free_image(&expected);
+	}
+
+	free(allocation.temporary_memory.memory);
+	free(allocation.return_data_memory.memory);
+	return passed ? 0 : 1;
+}
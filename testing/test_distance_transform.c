@@ -0,0 +1,115 @@
+/*
+ * Checks that the distance transform is exact, against a brute force search for the nearest seed of every pixel.
+ * The image is very wide, since the squared distances it works with stop fitting in a float from around 4096 pixels.
+ */
+#include <stdio.h>
+#include <math.h>
+
+#define TEX2SDF_IMPLEMENTATION
+#include "../tex2sdf.h"
+
+#define WIDTH 16384
+#define HEIGHT 32
+#define RANGE 8
+#define SEARCH (RANGE + 2)
+
+static unsigned char mask[WIDTH * HEIGHT];
+
+static int is_inside(int x, int y)
+{
+	// Outside the bounds of the image is outer
+	return x >= 0 && y >= 0 && x < WIDTH && y < HEIGHT && mask[y * WIDTH + x];
+}
+
+static int is_edge(int x, int y)
+{
+	// On a different side to any of its 8 neighbours
+	for(int other_y = y - 1; other_y <= y + 1; ++other_y) {
+		for(int other_x = x - 1; other_x <= x + 1; ++other_x) {
+			if(is_inside(other_x, other_y) != is_inside(x, y)) {
+				return 1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	// 1. Scattered small squares
+	unsigned int random = 1;
+	for(int n = 0; n < WIDTH * HEIGHT / 300; ++n) {
+		random = random * 1103515245u + 12345u;
+		const int center_x = (int)((random >> 8) % WIDTH);
+		random = random * 1103515245u + 12345u;
+		const int center_y = (int)((random >> 8) % HEIGHT);
+
+		for(int y = center_y - 1; y <= center_y + 1; ++y) {
+			for(int x = center_x - 1; x <= center_x + 1; ++x) {
+				if(x >= 0 && y >= 0 && x < WIDTH && y < HEIGHT) {
+					mask[y * WIDTH + x] = 255;
+				}
+			}
+		}
+	}
+
+	// 2. Convert (column-major, so the buffer rows run along the wide side)
+	struct T2S_Options options = t2s_get_default_options();
+	options.sdf_range = (float)RANGE;
+	options.algorithm = TEX2SDF_ALGORITHM_DISTANCE_TRANSFORM;
+	options.sweep_order = TEX2SDF_SWEEP_COLUMN_MAJOR;
+
+	struct T2S_Image input = { mask, WIDTH, HEIGHT, 1 };
+	struct T2S_Image sdf = t2s_convert(input, options);
+	if(sdf.error) {
+		fprintf(stderr, "%s\n", t2s_get_error_string(sdf.error));
+		return 1;
+	}
+
+	// 3. Every pixel that is not an edge measures to the nearest edge pixel on the other side,
+	//	  which is half a pixel further than the outline between them. (Fully inside or outside edge pixels load as 0.75, which is half a pixel)
+	long failed_count = 0;
+	for(int y = 0; y < HEIGHT; ++y) {
+		for(int x = 0; x < WIDTH; ++x) {
+			if(is_edge(x, y)) {
+				continue;
+			}
+
+			const int inside = is_inside(x, y);
+			int nearest = SEARCH * SEARCH * 2;
+			for(int other_y = y - SEARCH; other_y <= y + SEARCH; ++other_y) {
+				for(int other_x = x - SEARCH; other_x <= x + SEARCH; ++other_x) {
+					const int is_outside_image = other_x < 0 || other_y < 0 || other_x >= WIDTH || other_y >= HEIGHT;
+					if(is_outside_image ? !inside || (other_x != x && other_y != y) : !is_edge(other_x, other_y) || is_inside(other_x, other_y) == inside) {
+						continue;
+					}
+
+					const int distance = (other_x - x) * (other_x - x) + (other_y - y) * (other_y - y);
+					nearest = distance < nearest ? distance : nearest;
+				}
+			}
+			if(nearest > RANGE * RANGE) {
+				continue;
+			}
+
+			const float distance = (sqrtf((float)nearest) - 0.5f) * (inside ? -1.0f : 1.0f);
+			const int expected = (int)((distance / (float)RANGE + 1.0f) * 127.5f);
+			const int actual = sdf.data[y * WIDTH + x];
+			if(actual - expected > 1 || expected - actual > 1) {
+				if(failed_count < 10) {
+					fprintf(stderr, "(%d, %d) is %d, expected %d\n", x, y, actual, expected);
+				}
+				failed_count += 1;
+			}
+		}
+	}
+
+	t2s_free_image(&sdf);
+	if(failed_count > 0) {
+		fprintf(stderr, "%ld pixels are off\n", failed_count);
+		return 1;
+	}
+
+	return 0;
+}
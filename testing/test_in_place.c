@@ -0,0 +1,39 @@
+/*
+ * Checks that converting in_place gives the same SDF as converting into separate memory,
+ * through t2s_convert and through a T2S_Context, and that the SDF really is written over the input's data.
+ */
+#define TEX2SDF_IMPLEMENTATION
+#include "../tex2sdf.h"
+#include "test_common.h"
+
+int main(void)
+{
+	static unsigned char copy[MAX_BYTES];
+	struct T2S_Context context;
+	memset(&context, 0, sizeof(context));
+
+	int passed = 1;
+	for(int test = 0; test < 200; ++test) {
+		struct T2S_Image input = random_image(MAX_SIZE, 4);
+		struct T2S_Options options = random_options();
+
+		// 1. Converted from a copy first, since converting in place loses the input
+		memcpy(copy, input.data, (size_t)input.width * (size_t)input.height * (size_t)input.channels);
+		struct T2S_Image separate = input;
+		separate.data = copy;
+		struct T2S_Image expected = t2s_convert(separate, options);
+
+		// 2. In place, which returns the input's data without owning it
+		options.in_place = 1;
+		const struct T2S_Image actual = test % 2 ? t2s_convert_with_context(&context, input, options) : t2s_convert(input, options);
+		passed &= is_same("in_place", test, expected, actual);
+		if(actual.data != input.data || actual.data_is_owned) {
+			fprintf(stderr, "in_place %d: the SDF should be the input's data\n", test);
+			passed = 0;
+		}
+		t2s_free_image(&expected);
+	}
+
+	t2s_free_context(&context);
+	return passed ? 0 : 1;
+}
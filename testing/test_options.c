@@ -0,0 +1,112 @@
+/*
+ * Checks that the sweep orders and options that should not change the SDF really do not,
+ * for every algorithm against its own column-major reference (or for the wavefront, against itself on one thread).
+ * Prints a checksum of the reference and wavefront SDFs, so that builds with TEX2SDF_NO_SIMD or TEX2SDF_NO_DISPATCH can be compared against the default one.
+ */
+#define TEX2SDF_IMPLEMENTATION
+#include "../tex2sdf.h"
+#include "test_common.h"
+
+static struct T2S_Options reference_options(int test)
+{
+	// Random, apart from the options the checks change, and each algorithm in turn
+	struct T2S_Options options = random_options();
+	options.algorithm = test % TEX2SDF_ALGORITHM_COUNT;
+	options.sweep_order = TEX2SDF_SWEEP_COLUMN_MAJOR;
+	options.narrow_band = 0;
+	options.parallel_channels = 0;
+	options.interleaved_channels = 0;
+	options.compact_scratch = 0;
+	return options;
+}
+
+static int is_transpose_exact(int algorithm)
+{
+	// The algorithms that go from edge pixels to their nearest one can break ties between two equally near ones differently when transposed
+	// (see the sweep order enum values). AUTO can pick any of them.
+	return algorithm != TEX2SDF_ALGORITHM_DISTANCE_TRANSFORM && algorithm != TEX2SDF_ALGORITHM_JUMP_FLOODING &&
+		   algorithm != TEX2SDF_ALGORITHM_DEAD_RECKONING && algorithm != TEX2SDF_ALGORITHM_AUTO;
+}
+
+static void add_to_checksum(unsigned int *checksum, struct T2S_Image image)
+{
+	// FNV-1a
+	const size_t size = (size_t)image.width * (size_t)image.height * (size_t)image.channels;
+	for(size_t i = 0; !image.error && i < size; ++i) {
+		*checksum = (*checksum ^ image.data[i]) * 16777619u;
+	}
+}
+
+int main(void)
+{
+	static unsigned char reference_data[MAX_BYTES];
+	unsigned int checksum = 2166136261u;
+	int passed = 1;
+
+	for(int test = 0; test < 200; ++test) {
+		const struct T2S_Image input = random_image(MAX_SIZE, 4);
+		const struct T2S_Options options = reference_options(test);
+
+		struct T2S_Image reference = t2s_convert(input, options);
+		if(reference.error) {
+			fprintf(stderr, "options %d: %s\n", test, t2s_get_error_string(reference.error));
+			passed = 0;
+			continue;
+		}
+		const size_t size = (size_t)input.width * (size_t)input.height * (size_t)input.channels;
+		memcpy(reference_data, reference.data, size);
+		t2s_free_image(&reference);
+		reference.data = reference_data;
+
+		add_to_checksum(&checksum, reference);
+
+		// 1. The same walk, with the buffers transposed
+		struct T2S_Options changed = options;
+		struct T2S_Image actual;
+		if(is_transpose_exact(options.algorithm)) {
+			changed.sweep_order = TEX2SDF_SWEEP_ROW_MAJOR;
+			actual = t2s_convert(input, changed);
+			passed &= is_same("row_major", test, reference, actual);
+			t2s_free_image(&actual);
+		}
+
+		// 2. The wavefront visits pixels in a different order, so it only has to give the same SDF for any number of threads
+		changed = options;
+		changed.sweep_order = TEX2SDF_SWEEP_WAVEFRONT;
+		changed.thread_count = 1;
+		struct T2S_Image wavefront = t2s_convert(input, changed);
+		changed.thread_count = 0;
+		actual = t2s_convert(input, changed);
+		passed &= is_same("wavefront", test, wavefront, actual);
+		add_to_checksum(&checksum, wavefront);
+		t2s_free_image(&wavefront);
+		t2s_free_image(&actual);
+
+		// 3. Each channel converted by its own worker, in its own temporary memory
+		changed = options;
+		changed.parallel_channels = 1;
+		actual = t2s_convert(input, changed);
+		passed &= is_same("parallel_channels", test, reference, actual);
+		t2s_free_image(&actual);
+
+		// 4. All the channels together, in SIMD lanes (float distances only), which also turns parallel_channels off
+		if(input.channels > 1 && !options.fixed_point_distances) {
+			changed = options;
+			changed.interleaved_channels = 1;
+			changed.parallel_channels = 1;
+			actual = t2s_convert(input, changed);
+			passed &= is_same("interleaved_channels", test, reference, actual);
+			t2s_free_image(&actual);
+		}
+
+		// 5. The edges stored 1 bit per pixel
+		changed = options;
+		changed.compact_scratch = 1;
+		actual = t2s_convert(input, changed);
+		passed &= is_same("compact_scratch", test, reference, actual);
+		t2s_free_image(&actual);
+	}
+
+	printf("%08x\n", checksum);
+	return passed ? 0 : 1;
+}